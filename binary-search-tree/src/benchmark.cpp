@@ -0,0 +1,149 @@
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#include <sstream>
+
+#include "./include/adaptive_huffman.hpp"
+#include "./include/binary_search_tree.hpp"
+#include "./include/huffman.hpp"
+
+using namespace std;
+
+template <typename Function>
+double measure_ms(Function fn) {
+  auto start = chrono::steady_clock::now();
+  fn();
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void generate_input(const string& path, int keys) {
+  srand(42);
+  ofstream generated(path);
+  for (int i = 0; i < keys; i++) generated << "<" << rand() << "," << char('A' + i % 26) << ">" << endl;
+  generated.close();
+}
+
+void parallel_benchmark(int keys) {
+  generate_input("benchmark_input.txt", keys);
+  ifstream input("benchmark_input.txt");
+  BinarySearchTree bst(input);
+  input.close();
+
+  cout << "Parallel traversal (" << keys << " keys, " << resolve_threads(0) << " hardware threads)" << endl;
+
+  ostringstream sequential_out;
+  double visit_ms = measure_ms([&]() { bst.visit(bst.get_root(), Visit::inorder, sequential_out); });
+  cout << "Sequential inorder visit => " << visit_ms << " ms" << endl;
+
+  for (unsigned threads = 1; threads <= 8; threads *= 2) {
+    // Workers start here, outside the timed sections
+    ThreadPool pool(threads);
+    long long sum = 0;
+    double reduce_ms = measure_ms([&]() {
+      sum = bst.parallel_reduce(
+          bst.get_root(), 0LL, [](const Node& node) { return (long long)node.get_key(); },
+          [](long long a, long long b) { return a + b; }, pool);
+    });
+
+    ostringstream parallel_out;
+    double visit_ms = measure_ms([&]() { bst.parallel_visit(bst.get_root(), pool, parallel_out); });
+
+    cout << threads << " threads => reduce: " << reduce_ms << " ms (sum " << sum << ") - inorder visit: " << visit_ms
+         << " ms" << (parallel_out.str() == sequential_out.str() ? "" : " (OUTPUT MISMATCH)") << endl;
+  }
+  cout << endl;
+}
+
+void scan_benchmark(int keys) {
+  generate_input("benchmark_input.txt", keys);
+  ifstream input("benchmark_input.txt");
+  BinarySearchTree bst(input);
+  input.close();
+
+  cout << "Full forward scan (" << keys << " keys)" << endl;
+
+  long long successor_sum = 0;
+  double successor_ms = measure_ms([&]() {
+    for (auto node = bst.tree_minimum(bst.get_root()); node; node = bst.get_successor(node))
+      successor_sum += node->get_key();
+  });
+
+  long long cursor_sum = 0;
+  double cursor_ms = measure_ms([&]() {
+    auto cursor = bst.get_cursor();
+    for (cursor.seek_first(); cursor.valid(); cursor.next()) cursor_sum += cursor.get_key();
+  });
+
+  cout << "get_successor => " << successor_ms << " ms (sum " << successor_sum << ")" << endl;
+  cout << "Cursor        => " << cursor_ms << " ms (sum " << cursor_sum << ")" << endl;
+  cout << endl;
+}
+
+// Skewed text over 'a'..'z' (the static table format cannot carry whitespace)
+string generate_text(int length) {
+  string text;
+  srand(42);
+  for (int i = 0; i < length; i++) {
+    int r = rand() % 100;
+    text += char('a' + (r < 50 ? r % 4 : r < 80 ? 4 + r % 8 : 12 + r % 14));
+  }
+  return text;
+}
+
+int count_bits(const string& encoded) {
+  int bits = 0;
+  for (auto& bit : encoded)
+    if (bit == '0' || bit == '1') bits++;
+  return bits;
+}
+
+void huffman_benchmark(int length) {
+  const string text = generate_text(length);
+  cout << "Huffman coding (" << length << " symbols)" << endl;
+
+  unique_ptr<Huffman> huffman;
+  string static_encoded, static_decoded;
+  int table_entries = 0;
+  double static_encode_ms = measure_ms([&]() {
+    int frequencies[256] = {0};
+    for (auto& ch : text) frequencies[static_cast<unsigned char>(ch)]++;
+
+    ofstream table("benchmark_input.txt");
+    for (int ch = 0; ch < 256; ch++)
+      if (frequencies[ch]) {
+        table << "<" << frequencies[ch] << "," << char(ch) << ">" << endl;
+        table_entries++;
+      }
+    table.close();
+
+    ifstream input("benchmark_input.txt");
+    huffman.reset(new Huffman(input));
+    static_encoded = huffman->encode(text);
+  });
+  double static_decode_ms = measure_ms([&]() { static_decoded = huffman->decode(static_encoded); });
+
+  AdaptiveHuffman encoder, decoder;
+  string adaptive_encoded, adaptive_decoded;
+  double adaptive_encode_ms = measure_ms([&]() { adaptive_encoded = encoder.encode(text); });
+  double adaptive_decode_ms = measure_ms([&]() { adaptive_decoded = decoder.decode(adaptive_encoded); });
+
+  // Static header: one 8-bit symbol and one 32-bit frequency per table entry
+  const int static_bits = count_bits(static_encoded) + table_entries * 40;
+  const int adaptive_bits = count_bits(adaptive_encoded);
+
+  cout << "Static (two-pass) => encode: " << static_encode_ms << " ms - decode: " << static_decode_ms << " ms - ratio: "
+       << static_bits / (8.0 * length) << (static_decoded == text ? "" : " (DECODE MISMATCH)") << endl;
+  cout << "Adaptive (FGK)    => encode: " << adaptive_encode_ms << " ms - decode: " << adaptive_decode_ms
+       << " ms - ratio: " << adaptive_bits / (8.0 * length) << (adaptive_decoded == text ? "" : " (DECODE MISMATCH)")
+       << endl;
+  cout << endl;
+}
+
+int main() {
+  parallel_benchmark(1000000);
+  scan_benchmark(1000000);
+  huffman_benchmark(1000000);
+
+  return 0;
+}
@@ -0,0 +1,14 @@
+# Project compilation
+g++ -std=c++11 -O2 -pthread benchmark.cpp -o benchmark.exe
+
+# Verify compilation result
+if ($?) {
+    Write-Host "Compilation completed successfully!`n"
+    
+    # Run program builded
+    ./benchmark.exe
+    "`n"
+}
+else {
+    Write-Host "Error in compiling!`n"
+}
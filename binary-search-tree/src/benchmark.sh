@@ -0,0 +1,17 @@
+#!/bin/bash
+
+# Project compilation
+g++ -std=c++11 -O2 -pthread benchmark.cpp -o benchmark
+
+# Verify compilation result
+if [ $? -eq 0 ]; then
+    echo "Compilation completed successfully!"
+    echo ""
+    
+    # Run the built program
+    ./benchmark
+    echo ""
+else
+    echo "Error in compiling!"
+    echo ""
+fi
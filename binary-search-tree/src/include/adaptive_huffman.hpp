@@ -0,0 +1,179 @@
+#ifndef ADAPTIVE_HUFFMAN_HPP
+#define ADAPTIVE_HUFFMAN_HPP
+
+#include <algorithm>
+#include <cstddef>
+#include <iostream>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Single-pass adaptive Huffman coder (FGK algorithm). Encoder and decoder start from
+// the same tree holding only the NYT ("not yet transmitted") node and update it after
+// every symbol, so no frequency table or header is needed. A symbol seen for the first
+// time is sent as the NYT code followed by its 8 raw bits.
+//
+// The tree is a flat array indexed by FGK node number: the root has the highest
+// number and weights never decrease as the number grows (sibling property).
+class AdaptiveHuffman {
+  static const int symbols = 256;
+  static const int max_nodes = 2 * symbols + 1;
+  static const int root = max_nodes - 1;
+
+  struct AdaptiveNode {
+    int weight, parent, left, right, symbol;
+  };
+
+  std::vector<AdaptiveNode> tree;
+  std::vector<int> leaves;
+  int nyt;
+
+  int current;
+  bool reading_symbol;
+  int pending_bits, pending_symbol;
+
+  bool is_leaf(const int node) const { return tree[node].left == -1; }
+
+  void relink(const int node) {
+    if (tree[node].symbol != -1) leaves[tree[node].symbol] = node;
+    if (!is_leaf(node)) {
+      tree[tree[node].left].parent = node;
+      tree[tree[node].right].parent = node;
+    }
+  }
+
+  // Exchanges the subtrees at two positions; each position keeps its parent
+  void swap_nodes(const int a, const int b) {
+    std::swap(tree[a].weight, tree[b].weight);
+    std::swap(tree[a].left, tree[b].left);
+    std::swap(tree[a].right, tree[b].right);
+    std::swap(tree[a].symbol, tree[b].symbol);
+    relink(a);
+    relink(b);
+
+    if (nyt == a)
+      nyt = b;
+    else if (nyt == b)
+      nyt = a;
+  }
+
+  void update(const int symbol) {
+    int node = leaves[symbol];
+
+    if (node == -1) {
+      const int parent = nyt;
+      tree[parent].left = parent - 2;
+      tree[parent].right = parent - 1;
+      tree[parent - 2] = {0, parent, -1, -1, -1};
+      tree[parent - 1] = {0, parent, -1, -1, symbol};
+
+      nyt = parent - 2;
+      node = leaves[symbol] = parent - 1;
+    }
+
+    while (node != -1) {
+      int leader = node;
+      while (leader < root && tree[leader + 1].weight == tree[node].weight) leader++;
+
+      if (leader != node && leader != tree[node].parent) {
+        swap_nodes(node, leader);
+        node = leader;
+      }
+
+      tree[node].weight++;
+      node = tree[node].parent;
+    }
+  }
+
+  void append_code(int node, std::string& bits) const {
+    const std::size_t start = bits.size();
+    for (; node != root; node = tree[node].parent) bits += tree[tree[node].parent].right == node ? '1' : '0';
+    std::reverse(bits.begin() + start, bits.end());
+  }
+
+public:
+  AdaptiveHuffman() { reset(); }
+
+  void reset() {
+    tree.assign(max_nodes, {0, -1, -1, -1, -1});
+    leaves.assign(symbols, -1);
+    nyt = current = root;
+    reading_symbol = true;
+    pending_bits = pending_symbol = 0;
+  }
+
+  // Streaming encoder: appends the code of ch to bits and updates the tree
+  void encode_symbol(const char ch, std::string& bits) {
+    const int symbol = static_cast<unsigned char>(ch);
+
+    if (leaves[symbol] == -1) {
+      append_code(nyt, bits);
+      for (int i = 7; i >= 0; i--) bits += (symbol >> i) & 1 ? '1' : '0';
+    } else
+      append_code(leaves[symbol], bits);
+
+    update(symbol);
+  }
+
+  // Streaming decoder: consumes one bit and returns true when it completes a symbol.
+  // Characters other than '0' and '1' are ignored.
+  bool decode_bit(const char bit, char& ch) {
+    if (bit != '0' && bit != '1') return false;
+
+    if (reading_symbol) {
+      pending_symbol = (pending_symbol << 1) | (bit == '1');
+      if (++pending_bits < 8) return false;
+
+      ch = static_cast<char>(pending_symbol);
+      update(pending_symbol);
+      reading_symbol = false;
+      pending_bits = pending_symbol = 0;
+      current = root;
+      return true;
+    }
+
+    current = bit == '0' ? tree[current].left : tree[current].right;
+    if (current == nyt) {
+      reading_symbol = true;
+      return false;
+    }
+    if (!is_leaf(current)) return false;
+
+    ch = static_cast<char>(tree[current].symbol);
+    update(tree[current].symbol);
+    current = root;
+    return true;
+  }
+
+  std::string encode(const std::string& input) {
+    reset();
+    std::string encoded;
+    for (auto& ch : input) encode_symbol(ch, encoded);
+    return encoded;
+  }
+
+  std::string decode(const std::string& encoded) {
+    reset();
+    std::string decoded;
+    char ch;
+    for (auto& bit : encoded)
+      if (decode_bit(bit, ch)) decoded += ch;
+    return decoded;
+  }
+
+  void print_encode(const std::string& input, std::ostream& out = std::cout) {
+    const std::string encoded = encode(input);
+    (encoded.empty() ? out << "Encoded string is empty"
+                     : out << "Adaptive encoded string for input \"" << input << "\" => " << encoded);
+    out << std::endl;
+  }
+
+  void print_decode(const std::string& encoded, std::ostream& out = std::cout) {
+    const std::string decoded = decode(encoded);
+    (decoded.empty() ? out << "Decoded string is empty"
+                     : out << "Adaptive decoded string for encoded string \"" << encoded << "\" => " << decoded);
+    out << std::endl;
+  }
+};
+
+#endif
@@ -1,13 +1,16 @@
 #ifndef BINARY_SEARCH_TREE
 #define BINARY_SEARCH_TREE
 
+#include <cstddef>
 #include <fstream>
 #include <sstream>
 #include <string>
+#include <vector>
 
 enum Visit { preorder, postorder, inorder };
 
 #include "node.hpp"
+#include "parallel.hpp"
 
 inline void format_line(std::string& line) {
   if (line.empty()) return;
@@ -65,7 +68,112 @@ class BinarySearchTree {
     }
   }
 
+  std::size_t bounded_size(const shared_node& node, std::size_t limit) const {
+    if (!node || limit == 0) return 0;
+    std::size_t count = 1 + bounded_size(node->get_left(), limit - 1);
+    if (count < limit) count += bounded_size(node->get_right(), limit - count);
+    return count;
+  }
+
+  // Splits the top levels of the tree into subtree tasks separated by the nodes above
+  // them: the in-order sequence is tasks[0], splits[0], tasks[1], ..., tasks.back().
+  // Subtrees smaller than cutoff are never split further.
+  void split_tasks(const shared_node& node, std::size_t depth, std::size_t cutoff, std::vector<shared_node>& tasks,
+                   std::vector<shared_node>& splits) const {
+    if (!node || depth == 0 || bounded_size(node, cutoff) < cutoff) {
+      tasks.push_back(node);
+      return;
+    }
+    split_tasks(node->get_left(), depth - 1, cutoff, tasks, splits);
+    splits.push_back(node);
+    split_tasks(node->get_right(), depth - 1, cutoff, tasks, splits);
+  }
+
+  template <typename Function>
+  void inorder_apply(const shared_node& node, Function& fn) const {
+    if (!node) return;
+    inorder_apply(node->get_left(), fn);
+    fn(*node);
+    inorder_apply(node->get_right(), fn);
+  }
+
 public:
+  // In-order cursor that keeps the root-to-node path as raw pointers, so next() and
+  // prev() are amortised O(1) without weak_ptr::lock() or refcount updates.
+  // The tree must not be modified while a cursor is in use.
+  class Cursor {
+    const Node* root;
+    std::vector<const Node*> path;
+
+  public:
+    explicit Cursor(const shared_node& root) : root(root.get()) {}
+
+    bool valid() const { return !path.empty(); }
+    const Node& get() const { return *path.back(); }
+    int get_key() const { return path.back()->get_key(); }
+
+    void seek_first() {
+      path.clear();
+      for (const Node* node = root; node; node = node->get_left().get()) path.push_back(node);
+    }
+
+    void seek_last() {
+      path.clear();
+      for (const Node* node = root; node; node = node->get_right().get()) path.push_back(node);
+    }
+
+    // Moves to the first node whose key is >= key
+    bool seek(const int key) {
+      path.clear();
+      std::size_t depth = 0;
+
+      const Node* node = root;
+      while (node) {
+        path.push_back(node);
+        if (node->get_key() >= key) {
+          depth = path.size();
+          node = node->get_left().get();
+        } else
+          node = node->get_right().get();
+      }
+
+      path.resize(depth);
+      return valid();
+    }
+
+    void next() {
+      if (!valid()) return;
+
+      const Node* node = path.back();
+      if (node->get_right()) {
+        for (node = node->get_right().get(); node; node = node->get_left().get()) path.push_back(node);
+        return;
+      }
+
+      path.pop_back();
+      while (valid() && path.back()->get_right().get() == node) {
+        node = path.back();
+        path.pop_back();
+      }
+    }
+
+    void prev() {
+      if (!valid()) return;
+
+      const Node* node = path.back();
+      if (node->get_left()) {
+        for (node = node->get_left().get(); node; node = node->get_right().get()) path.push_back(node);
+        return;
+      }
+
+      path.pop_back();
+      while (valid() && path.back()->get_left().get() == node) {
+        node = path.back();
+        path.pop_back();
+      }
+    }
+  };
+
   BinarySearchTree(std::ifstream& input) : root(nullptr) { load(input); }
 
   void delete_subtree(shared_node& node) {
@@ -77,6 +185,7 @@ public:
   }
 
   shared_node get_root() const { return root; }
+  Cursor get_cursor() const { return Cursor(root); }
 
   void load(std::ifstream& input) {
     delete_subtree(root);
@@ -201,6 +310,62 @@ public:
       }
     }
   }
+
+  // fn is called once per node, concurrently and in no particular order
+  template <typename Function>
+  void parallel_for_each(const shared_node& node, Function fn, ThreadPool& pool, std::size_t cutoff = 4096) const {
+    std::vector<shared_node> tasks, splits;
+    split_tasks(node, split_depth(pool.size()), cutoff, tasks, splits);
+
+    pool.run(tasks.size(), [&](std::size_t i) { inorder_apply(tasks[i], fn); });
+    for (auto& split : splits) fn(*split);
+  }
+
+  // Folds map(node) over the subtree in key order; combine must be associative
+  // and identity its neutral element
+  template <typename T, typename Map, typename Combine>
+  T parallel_reduce(const shared_node& node, T identity, Map map, Combine combine, ThreadPool& pool,
+                    std::size_t cutoff = 4096) const {
+    std::vector<shared_node> tasks, splits;
+    split_tasks(node, split_depth(pool.size()), cutoff, tasks, splits);
+
+    // Wrapped so that T = bool does not select the bit-packed vector<bool>
+    struct Partial {
+      T value;
+    };
+    std::vector<Partial> partials(tasks.size(), Partial{identity});
+    pool.run(tasks.size(), [&](std::size_t i) {
+      T accumulator = identity;
+      auto fold = [&](const Node& current) { accumulator = combine(accumulator, map(current)); };
+      inorder_apply(tasks[i], fold);
+      partials[i].value = accumulator;
+    });
+
+    T result = partials[0].value;
+    for (std::size_t i = 0; i < splits.size(); i++) {
+      result = combine(result, map(*splits[i]));
+      result = combine(result, partials[i + 1].value);
+    }
+    return result;
+  }
+
+  // Same output as visit(node, Visit::inorder, out): every subtree task prints into
+  // its own buffer and the buffers are concatenated in key order
+  void parallel_visit(const shared_node& node, ThreadPool& pool, std::ostream& out = std::cout,
+                      std::size_t cutoff = 4096) const {
+    std::vector<shared_node> tasks, splits;
+    split_tasks(node, split_depth(pool.size()), cutoff, tasks, splits);
+
+    std::vector<std::ostringstream> buffers(tasks.size());
+    pool.run(tasks.size(), [&](std::size_t i) { inorder_visit(tasks[i], buffers[i]); });
+
+    out << "Inorder visit" << std::endl;
+    out << buffers[0].str();
+    for (std::size_t i = 0; i < splits.size(); i++) {
+      splits[i]->print(out);
+      out << buffers[i + 1].str();
+    }
+  }
 };
 
 #endif
\ No newline at end of file
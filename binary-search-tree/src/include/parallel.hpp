@@ -0,0 +1,127 @@
+#ifndef PARALLEL_HPP
+#define PARALLEL_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+inline unsigned resolve_threads(unsigned threads) {
+  if (threads == 0) threads = std::thread::hardware_concurrency();
+  return threads == 0 ? 1 : threads;
+}
+
+// Number of tree levels to fork so that there are about four subtrees per thread
+inline std::size_t split_depth(unsigned threads) {
+  std::size_t depth = 0;
+  while ((std::size_t(1) << depth) < 4 * std::size_t(resolve_threads(threads))) depth++;
+  return depth;
+}
+
+// Persistent worker pool: its threads are started once by the constructor and reused
+// by every run(), so thread start-up is not paid per traversal. The calling thread
+// takes part in each run, so a pool of n threads owns n - 1 workers.
+// run() must not be called concurrently or from inside a task.
+class ThreadPool {
+  std::vector<std::thread> workers;
+  std::mutex lock;
+  std::condition_variable work_ready, work_done;
+
+  std::function<void(std::size_t)> job;
+  std::size_t job_count = 0;
+  std::atomic<std::size_t> next;
+  std::size_t generation = 0;
+  std::size_t running = 0;
+  bool stopping = false;
+  std::exception_ptr error;
+
+  // Idle threads claim the next pending task, so uneven subtrees are balanced.
+  // The first exception thrown by a task is kept for run() and no new tasks start.
+  void work() {
+    for (std::size_t i = next++; i < job_count; i = next++) {
+      try {
+        job(i);
+      } catch (...) {
+        std::lock_guard<std::mutex> guard(lock);
+        if (!error) error = std::current_exception();
+        next = job_count;
+      }
+    }
+  }
+
+  void worker_loop() {
+    std::size_t seen = 0;
+    while (true) {
+      {
+        std::unique_lock<std::mutex> guard(lock);
+        work_ready.wait(guard, [&]() { return stopping || generation != seen; });
+        if (stopping) return;
+        seen = generation;
+      }
+
+      work();
+
+      std::lock_guard<std::mutex> guard(lock);
+      if (--running == 0) work_done.notify_one();
+    }
+  }
+
+public:
+  explicit ThreadPool(unsigned threads = 0) : next(0) {
+    for (unsigned i = 1; i < resolve_threads(threads); i++) workers.emplace_back(&ThreadPool::worker_loop, this);
+  }
+
+  ThreadPool(const ThreadPool&) = delete;
+  ThreadPool& operator=(const ThreadPool&) = delete;
+
+  ~ThreadPool() {
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      stopping = true;
+    }
+    work_ready.notify_all();
+    for (auto& worker : workers) worker.join();
+  }
+
+  unsigned size() const { return unsigned(workers.size()) + 1; }
+
+  // Runs task(0) ... task(count - 1) and returns once all of them have finished.
+  // If a task throws, the workers are still waited for before the first exception
+  // is rethrown here, so the pool stays usable.
+  template <typename Task>
+  void run(std::size_t count, Task task) {
+    if (workers.empty() || count <= 1) {
+      for (std::size_t i = 0; i < count; i++) task(i);
+      return;
+    }
+
+    {
+      std::lock_guard<std::mutex> guard(lock);
+      job = [&task](std::size_t i) { task(i); };
+      job_count = count;
+      next = 0;
+      running = workers.size();
+      generation++;
+    }
+    work_ready.notify_all();
+
+    work();
+
+    std::unique_lock<std::mutex> guard(lock);
+    work_done.wait(guard, [&]() { return running == 0; });
+    job = nullptr;
+
+    if (error) {
+      std::exception_ptr thrown = error;
+      error = nullptr;
+      std::rethrow_exception(thrown);
+    }
+  }
+};
+
+#endif
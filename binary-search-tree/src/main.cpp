@@ -1,3 +1,4 @@
+#include "./include/adaptive_huffman.hpp"
 #include "./include/binary_search_tree.hpp"
 #include "./include/huffman.hpp"
 
@@ -16,6 +17,11 @@ int main() {
   bst.print_predecessor(bst.get_root());
   bst.print_successor(bst.get_root());
 
+  cout << endl << "Cursor scan =>";
+  auto cursor = bst.get_cursor();
+  for (cursor.seek_first(); cursor.valid(); cursor.next()) cout << " " << cursor.get_key();
+  cout << endl;
+
   int key_search = 5;
   auto node_search = bst.search(bst.get_root(), key_search);
   if (node_search) {
@@ -31,6 +37,10 @@ int main() {
   h.print_encode(huffman_input_str);
   h.print_decode(h.encode(huffman_input_str));
 
+  AdaptiveHuffman adaptive;
+  adaptive.print_encode(huffman_input_str);
+  adaptive.print_decode(adaptive.encode(huffman_input_str));
+
   input.close();
   exam_input.close();
   output.close();
@@ -0,0 +1,131 @@
+#include <chrono>
+#include <cstdlib>
+#include <utility>
+#include <vector>
+
+#include "./include/compact_red_black_tree.hpp"
+#include "./include/red_black_tree.hpp"
+
+using namespace std;
+
+template <typename Function>
+double measure_ms(Function fn) {
+  auto start = chrono::steady_clock::now();
+  fn();
+  return chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+}
+
+void interval_benchmark(int intervals, int queries) {
+  IntervalTree tree;
+  vector<pair<int, int>> ranges;
+
+  srand(42);
+  for (int i = 0; i < intervals; i++) {
+    int low = rand() % (intervals * 10);
+    int high = low + rand() % 100;
+    ranges.push_back(make_pair(low, high));
+    tree.tree_insert(create_interval_node(low, high));
+  }
+
+  vector<int> points;
+  for (int i = 0; i < queries; i++) points.push_back(rand() % (intervals * 10));
+
+  size_t tree_hits = 0, scan_hits = 0;
+  vector<IntervalNode*> result;
+
+  double tree_ms = measure_ms([&]() {
+    for (int point : points) {
+      result.clear();
+      tree.interval_search(tree.get_root(), point, point, result);
+      tree_hits += result.size();
+    }
+  });
+
+  double scan_ms = measure_ms([&]() {
+    for (int point : points)
+      for (auto& range : ranges)
+        if (range.first <= point && point <= range.second) scan_hits++;
+  });
+
+  cout << "Stabbing queries (" << intervals << " intervals, " << queries << " queries)" << endl;
+  cout << "Interval tree => " << tree_ms << " ms - hits: " << tree_hits << endl;
+  cout << "Linear scan   => " << scan_ms << " ms - hits: " << scan_hits << endl;
+  cout << endl;
+}
+
+void parallel_benchmark(int keys) {
+  RedBlackTree tree;
+
+  srand(42);
+  for (int i = 0; i < keys; i++) tree.tree_insert(new Node(rand()));
+
+  cout << "Parallel traversal (" << keys << " keys, " << resolve_threads(0) << " hardware threads)" << endl;
+
+  for (unsigned threads = 1; threads <= 8; threads *= 2) {
+    // Workers start here, outside the timed sections
+    ThreadPool pool(threads);
+    long long sum = 0;
+    double reduce_ms = measure_ms([&]() {
+      sum = tree.parallel_reduce(
+          0LL, [](Node* node) { return (long long)node->key; }, [](long long a, long long b) { return a + b; },
+          pool);
+    });
+
+    vector<Node*> nodes;
+    nodes.reserve(keys);
+    double inorder_ms = measure_ms([&]() { tree.parallel_inorder(nodes, pool); });
+
+    cout << threads << " threads => reduce: " << reduce_ms << " ms (sum " << sum << ") - inorder export: " << inorder_ms
+         << " ms" << endl;
+  }
+  cout << endl;
+}
+
+void print_memory_usage(const string& name, const MemoryUsage& usage) {
+  cout << name << " => " << usage.bytes / (1024.0 * 1024.0) << " MiB - " << usage.node_bytes << " bytes per node - "
+       << usage.bytes_per_key() << " bytes per key" << endl;
+}
+
+void memory_benchmark(int keys, int lookups) {
+  RedBlackTree tree;
+  CompactRedBlackTree compact;
+  compact.reserve(keys);
+
+  srand(42);
+  for (int i = 0; i < keys; i++) {
+    int key = rand();
+    tree.tree_insert(new Node(key));
+    compact.tree_insert(key);
+  }
+
+  vector<int> queries;
+  for (int i = 0; i < lookups; i++) queries.push_back(rand());
+
+  cout << "Memory footprint and lookups (" << keys << " keys, " << lookups << " lookups)" << endl;
+  print_memory_usage("RedBlackTree       ", tree.memory_usage());
+  print_memory_usage("CompactRedBlackTree", compact.memory_usage());
+  cout << "(RedBlackTree excludes malloc overhead of its one-allocation-per-node storage; "
+       << "CompactRedBlackTree is a single arena allocation)" << endl;
+
+  size_t tree_found = 0, compact_found = 0;
+  double tree_ms = measure_ms([&]() {
+    for (int key : queries)
+      if (tree.tree_search(tree.get_root(), key) != tree.get_nil()) tree_found++;
+  });
+  double compact_ms = measure_ms([&]() {
+    for (int key : queries)
+      if (compact.contains(key)) compact_found++;
+  });
+
+  cout << "RedBlackTree lookups        => " << tree_ms << " ms - found: " << tree_found << endl;
+  cout << "CompactRedBlackTree lookups => " << compact_ms << " ms - found: " << compact_found << endl;
+  cout << endl;
+}
+
+int main() {
+  interval_benchmark(100000, 1000);
+  parallel_benchmark(1000000);
+  memory_benchmark(1000000, 1000000);
+
+  return 0;
+}
@@ -0,0 +1,309 @@
+#ifndef COMPACT_RED_BLACK_TREE_HPP
+#define COMPACT_RED_BLACK_TREE_HPP
+
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "red_black_tree.hpp"
+
+using namespace std;
+
+// 16 bytes per key: children and parent are 32-bit indices into the tree's arena and
+// the color is packed into the top bit of the parent index. Indices are therefore
+// limited to 31 bits: an arena holds at most 2^31 slots (indices 0 to 2^31 - 1, sentinel
+// included), and tree_insert throws length_error instead of growing past that.
+struct CompactNode {
+  int key;
+  uint32_t left;
+  uint32_t right;
+  uint32_t parent_color;
+};
+
+// Red-Black Tree storing its nodes contiguously in an arena instead of one heap
+// allocation per node. Index 0 is the nil sentinel and removed slots are reused.
+// It has the same algorithms as RedBlackTree but no lazy deletion or intervals.
+class CompactRedBlackTree {
+private:
+  static const uint32_t nil = 0;
+  static const uint32_t red_bit = 0x80000000u;
+  static const uint32_t index_mask = 0x7fffffffu;
+
+  vector<CompactNode> nodes;
+  uint32_t root;
+  uint32_t free_list;
+  size_t count;
+
+  int get_key(uint32_t node) const { return nodes[node].key; }
+  uint32_t& left(uint32_t node) { return nodes[node].left; }
+  uint32_t& right(uint32_t node) { return nodes[node].right; }
+  uint32_t parent(uint32_t node) const { return nodes[node].parent_color & index_mask; }
+  void set_parent(uint32_t node, uint32_t parent) {
+    nodes[node].parent_color = (nodes[node].parent_color & red_bit) | parent;
+  }
+  Color color(uint32_t node) const { return nodes[node].parent_color & red_bit ? Color::red : Color::black; }
+  void set_color(uint32_t node, Color color) {
+    nodes[node].parent_color = (nodes[node].parent_color & index_mask) | (color == Color::red ? red_bit : 0);
+  }
+
+  uint32_t allocate(int key) {
+    CompactNode node = {key, nil, nil, red_bit};
+    if (free_list != nil) {
+      uint32_t index = free_list;
+      free_list = nodes[index].left;
+      nodes[index] = node;
+      return index;
+    }
+    if (nodes.size() > index_mask) throw length_error("CompactRedBlackTree: arena exceeds 2^31 slots");
+    nodes.push_back(node);
+    return uint32_t(nodes.size() - 1);
+  }
+
+  void release(uint32_t node) {
+    nodes[node].left = free_list;
+    free_list = node;
+  }
+
+  void left_rotate(uint32_t x) {
+    uint32_t y = right(x);
+    right(x) = left(y);
+    if (left(y) != nil) set_parent(left(y), x);
+    set_parent(y, parent(x));
+    if (parent(x) == nil)
+      root = y;
+    else if (x == left(parent(x)))
+      left(parent(x)) = y;
+    else
+      right(parent(x)) = y;
+    left(y) = x;
+    set_parent(x, y);
+  }
+
+  void right_rotate(uint32_t x) {
+    uint32_t y = left(x);
+    left(x) = right(y);
+    if (right(y) != nil) set_parent(right(y), x);
+    set_parent(y, parent(x));
+    if (parent(x) == nil)
+      root = y;
+    else if (x == right(parent(x)))
+      right(parent(x)) = y;
+    else
+      left(parent(x)) = y;
+    right(y) = x;
+    set_parent(x, y);
+  }
+
+  void fix_insert(uint32_t node) {
+    while (node != root && color(parent(node)) == Color::red) {
+      uint32_t grandparent = parent(parent(node));
+
+      if (parent(node) == left(grandparent)) {
+        uint32_t uncle = right(grandparent);
+
+        if (color(uncle) == Color::red) {
+          set_color(parent(node), Color::black);
+          set_color(uncle, Color::black);
+          set_color(grandparent, Color::red);
+          node = grandparent;
+        } else {
+          if (node == right(parent(node))) {
+            node = parent(node);
+            left_rotate(node);
+          }
+          set_color(parent(node), Color::black);
+          set_color(grandparent, Color::red);
+          right_rotate(grandparent);
+        }
+      } else {
+        uint32_t uncle = left(grandparent);
+
+        if (color(uncle) == Color::red) {
+          set_color(parent(node), Color::black);
+          set_color(uncle, Color::black);
+          set_color(grandparent, Color::red);
+          node = grandparent;
+        } else {
+          if (node == left(parent(node))) {
+            node = parent(node);
+            right_rotate(node);
+          }
+          set_color(parent(node), Color::black);
+          set_color(grandparent, Color::red);
+          left_rotate(grandparent);
+        }
+      }
+    }
+
+    set_color(root, Color::black);
+  }
+
+  void transplant(uint32_t u, uint32_t v) {
+    if (parent(u) == nil)
+      root = v;
+    else if (u == left(parent(u)))
+      left(parent(u)) = v;
+    else
+      right(parent(u)) = v;
+    set_parent(v, parent(u));
+  }
+
+  void fix_delete(uint32_t x) {
+    while (x != root && color(x) == Color::black) {
+      if (x == left(parent(x))) {
+        uint32_t w = right(parent(x));
+        if (color(w) == Color::red) {
+          set_color(w, Color::black);
+          set_color(parent(x), Color::red);
+          left_rotate(parent(x));
+          w = right(parent(x));
+        }
+
+        if (color(left(w)) == Color::black && color(right(w)) == Color::black) {
+          set_color(w, Color::red);
+          x = parent(x);
+        } else {
+          if (color(right(w)) == Color::black) {
+            set_color(left(w), Color::black);
+            set_color(w, Color::red);
+            right_rotate(w);
+            w = right(parent(x));
+          }
+          set_color(w, color(parent(x)));
+          set_color(parent(x), Color::black);
+          set_color(right(w), Color::black);
+          left_rotate(parent(x));
+          x = root;
+        }
+      } else {
+        uint32_t w = left(parent(x));
+        if (color(w) == Color::red) {
+          set_color(w, Color::black);
+          set_color(parent(x), Color::red);
+          right_rotate(parent(x));
+          w = left(parent(x));
+        }
+
+        if (color(right(w)) == Color::black && color(left(w)) == Color::black) {
+          set_color(w, Color::red);
+          x = parent(x);
+        } else {
+          if (color(left(w)) == Color::black) {
+            set_color(right(w), Color::black);
+            set_color(w, Color::red);
+            left_rotate(w);
+            w = left(parent(x));
+          }
+          set_color(w, color(parent(x)));
+          set_color(parent(x), Color::black);
+          set_color(left(w), Color::black);
+          right_rotate(parent(x));
+          x = root;
+        }
+      }
+    }
+    set_color(x, Color::black);
+  }
+
+  uint32_t tree_search(int key) const {
+    uint32_t node = root;
+    while (node != nil && key != nodes[node].key) node = key < nodes[node].key ? nodes[node].left : nodes[node].right;
+    return node;
+  }
+
+  uint32_t tree_minimum(uint32_t node) {
+    while (left(node) != nil) node = left(node);
+    return node;
+  }
+
+  void inorder_visit(uint32_t node) const {
+    if (node == nil) return;
+    inorder_visit(nodes[node].left);
+    cout << "Node: " << get_key(node) << " - Color: " << (color(node) == Color::red ? "red" : "black") << endl;
+    inorder_visit(nodes[node].right);
+  }
+
+public:
+  CompactRedBlackTree() : root(nil), free_list(nil), count(0) {
+    CompactNode sentinel = {0, nil, nil, 0};
+    nodes.push_back(sentinel);
+  }
+
+  size_t size() const { return count; }
+  void reserve(size_t keys) { nodes.reserve(keys + 1); }
+
+  bool contains(int key) const { return tree_search(key) != nil; }
+
+  void tree_insert(int key) {
+    uint32_t z = allocate(key);
+    uint32_t y = nil;
+    uint32_t x = root;
+    while (x != nil) {
+      y = x;
+      if (key < get_key(x))
+        x = left(x);
+      else
+        x = right(x);
+    }
+    set_parent(z, y);
+    if (y == nil)
+      root = z;
+    else if (key < get_key(y))
+      left(y) = z;
+    else
+      right(y) = z;
+    count++;
+    fix_insert(z);
+  }
+
+  // Removes one node holding key, if any
+  bool tree_delete(int key) {
+    uint32_t z = tree_search(key);
+    if (z == nil) return false;
+
+    uint32_t y = z;
+    uint32_t x;
+    Color y_original_color = color(y);
+
+    if (left(z) == nil) {
+      x = right(z);
+      transplant(z, right(z));
+    } else if (right(z) == nil) {
+      x = left(z);
+      transplant(z, left(z));
+    } else {
+      y = tree_minimum(right(z));
+      y_original_color = color(y);
+      x = right(y);
+      if (parent(y) == z)
+        set_parent(x, y);
+      else {
+        transplant(y, right(y));
+        right(y) = right(z);
+        set_parent(right(y), y);
+      }
+      transplant(z, y);
+      left(y) = left(z);
+      set_parent(left(y), y);
+      set_color(y, color(z));
+    }
+    if (y_original_color == Color::black) fix_delete(x);
+
+    release(z);
+    count--;
+    return true;
+  }
+
+  // Arena capacity (free slots and sentinel included) plus the tree object itself
+  MemoryUsage memory_usage() const {
+    MemoryUsage usage;
+    usage.keys = count;
+    usage.node_bytes = sizeof(CompactNode);
+    usage.bytes = nodes.capacity() * sizeof(CompactNode) + sizeof(*this);
+    return usage;
+  }
+
+  void inorder_visit() const { inorder_visit(root); }
+};
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef NODE_HPP
 #define NODE_HPP
 
+#include <climits>
 #include <iostream>
 #include <string>
 
@@ -8,15 +9,19 @@ using namespace std;
 
 enum Color { black, red };
 
-struct Node {
+// Fields shared by every Red-Black Tree node; Self is the concrete node type so that
+// the links point at it directly
+template <typename Self>
+struct TreeNode {
   int key;
-  Node* left = nullptr;
-  Node* right = nullptr;
-  Node* parent = nullptr;
+  Self* left = nullptr;
+  Self* right = nullptr;
+  Self* parent = nullptr;
   Color color;
+  bool deleted = false;
 
-  Node() {}
-  Node(int key, Node* left = nullptr, Node* right = nullptr, Node* parent = nullptr, Color color = Color::red)
+  TreeNode() {}
+  TreeNode(int key, Self* left, Self* right, Self* parent, Color color)
       : key(key), left(left), right(right), parent(parent), color(color) {};
 
   string get_color() {
@@ -31,8 +36,33 @@ struct Node {
 
     return "";
   }
+};
+
+struct Node : TreeNode<Node> {
+  Node() {}
+  Node(int key, Node* left = nullptr, Node* right = nullptr, Node* parent = nullptr, Color color = Color::red)
+      : TreeNode<Node>(key, left, right, parent, color) {};
 
-  void print() { cout << "Node: " << key << " - Color: " << get_color() << endl; };
+  void print() { cout << "Node: " << key << " - Color: " << get_color() << (deleted ? " - Deleted" : "") << endl; };
 };
 
-#endif
\ No newline at end of file
+// Node of an IntervalTree: interval [key, high] and the maximum high endpoint in the
+// subtree rooted here
+struct IntervalNode : TreeNode<IntervalNode> {
+  int high = INT_MIN;
+  int max_high = INT_MIN;
+
+  IntervalNode() {}
+  IntervalNode(int low, int high, IntervalNode* left = nullptr, IntervalNode* right = nullptr,
+               IntervalNode* parent = nullptr, Color color = Color::red)
+      : TreeNode<IntervalNode>(low, left, right, parent, color), high(high), max_high(high) {};
+
+  void print() {
+    cout << "Node: " << key << " - Interval: [" << key << ", " << high << "] - Max: " << max_high
+         << " - Color: " << get_color() << (deleted ? " - Deleted" : "") << endl;
+  };
+};
+
+inline IntervalNode* create_interval_node(int low, int high) { return new IntervalNode(low, high); }
+
+#endif
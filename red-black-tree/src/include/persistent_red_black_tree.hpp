@@ -0,0 +1,208 @@
+#ifndef PERSISTENT_RED_BLACK_TREE_HPP
+#define PERSISTENT_RED_BLACK_TREE_HPP
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include "node.hpp"
+
+using namespace std;
+
+// Immutable node: once built it is never modified, so it can be shared between versions.
+struct PersistentNode {
+  const int key;
+  const Color color;
+  const shared_ptr<const PersistentNode> left, right;
+
+  PersistentNode(Color color, const shared_ptr<const PersistentNode>& left, int key,
+                 const shared_ptr<const PersistentNode>& right)
+      : key(key), color(color), left(left), right(right) {}
+
+  string get_color() const { return color == Color::red ? "red" : "black"; }
+
+  void print() const { cout << "Node: " << key << " - Color: " << get_color() << endl; }
+};
+
+using persistent_node = shared_ptr<const PersistentNode>;
+
+// Ordered set backed by a persistent Red-Black Tree (path copying, no parent pointers).
+// Every insert/remove allocates only the O(log n) nodes on the search path and leaves
+// older versions untouched, so snapshot() is O(1) and a snapshot can be read from another
+// thread while this tree keeps changing. Duplicate keys are ignored.
+// Insertion and deletion follow Kahrs, "Red-black trees with types" (JFP 2001).
+class PersistentRedBlackTree {
+private:
+  persistent_node root;
+  size_t count;
+
+  PersistentRedBlackTree(const persistent_node& root, size_t count) : root(root), count(count) {}
+
+  static persistent_node make(Color color, const persistent_node& left, int key, const persistent_node& right) {
+    return make_shared<const PersistentNode>(color, left, key, right);
+  }
+
+  static bool is_red(const persistent_node& node) { return node && node->color == Color::red; }
+  static bool is_black(const persistent_node& node) { return node && node->color == Color::black; }
+
+  static persistent_node make_black(const persistent_node& node) {
+    if (!node || node->color == Color::black) return node;
+    return make(Color::black, node->left, node->key, node->right);
+  }
+
+  // Rebuilds a black node whose subtrees may contain a red-red violation
+  static persistent_node balance(const persistent_node& left, int key, const persistent_node& right) {
+    if (is_red(left) && is_red(right))
+      return make(Color::red, make_black(left), key, make_black(right));
+
+    if (is_red(left)) {
+      if (is_red(left->left))
+        return make(Color::red, make_black(left->left), left->key, make(Color::black, left->right, key, right));
+      if (is_red(left->right))
+        return make(Color::red, make(Color::black, left->left, left->key, left->right->left), left->right->key,
+                    make(Color::black, left->right->right, key, right));
+    }
+
+    if (is_red(right)) {
+      if (is_red(right->right))
+        return make(Color::red, make(Color::black, left, key, right->left), right->key, make_black(right->right));
+      if (is_red(right->left))
+        return make(Color::red, make(Color::black, left, key, right->left->left), right->left->key,
+                    make(Color::black, right->left->right, right->key, right->right));
+    }
+
+    return make(Color::black, left, key, right);
+  }
+
+  static persistent_node make_red(const persistent_node& node) {
+    return make(Color::red, node->left, node->key, node->right);
+  }
+
+  // Left subtree lost one black level
+  static persistent_node balance_left(const persistent_node& left, int key, const persistent_node& right) {
+    if (is_red(left)) return make(Color::red, make_black(left), key, right);
+    if (is_black(right)) return balance(left, key, make_red(right));
+    return make(Color::red, make(Color::black, left, key, right->left->left), right->left->key,
+                balance(right->left->right, right->key, make_red(right->right)));
+  }
+
+  // Right subtree lost one black level
+  static persistent_node balance_right(const persistent_node& left, int key, const persistent_node& right) {
+    if (is_red(right)) return make(Color::red, left, key, make_black(right));
+    if (is_black(left)) return balance(make_red(left), key, right);
+    return make(Color::red, balance(make_red(left->left), left->key, left->right->left), left->right->key,
+                make(Color::black, left->right->right, key, right));
+  }
+
+  static persistent_node insert_recursive(const persistent_node& node, int key) {
+    if (!node) return make(Color::red, nullptr, key, nullptr);
+
+    if (node->color == Color::black) {
+      if (key < node->key) return balance(insert_recursive(node->left, key), node->key, node->right);
+      return balance(node->left, node->key, insert_recursive(node->right, key));
+    }
+
+    if (key < node->key) return make(Color::red, insert_recursive(node->left, key), node->key, node->right);
+    return make(Color::red, node->left, node->key, insert_recursive(node->right, key));
+  }
+
+  // Joins two subtrees whose keys are ordered (all of left < all of right)
+  static persistent_node append(const persistent_node& left, const persistent_node& right) {
+    if (!left) return right;
+    if (!right) return left;
+
+    if (is_red(left) && is_red(right)) {
+      auto middle = append(left->right, right->left);
+      if (is_red(middle))
+        return make(Color::red, make(Color::red, left->left, left->key, middle->left), middle->key,
+                    make(Color::red, middle->right, right->key, right->right));
+      return make(Color::red, left->left, left->key, make(Color::red, middle, right->key, right->right));
+    }
+
+    if (is_black(left) && is_black(right)) {
+      auto middle = append(left->right, right->left);
+      if (is_red(middle))
+        return make(Color::red, make(Color::black, left->left, left->key, middle->left), middle->key,
+                    make(Color::black, middle->right, right->key, right->right));
+      return balance_left(left->left, left->key, make(Color::black, middle, right->key, right->right));
+    }
+
+    if (is_red(right)) return make(Color::red, append(left, right->left), right->key, right->right);
+    return make(Color::red, left->left, left->key, append(left->right, right));
+  }
+
+  static persistent_node remove_recursive(const persistent_node& node, int key) {
+    if (!node) return nullptr;
+
+    if (key < node->key) {
+      if (is_black(node->left)) return balance_left(remove_recursive(node->left, key), node->key, node->right);
+      return make(Color::red, remove_recursive(node->left, key), node->key, node->right);
+    }
+
+    if (key > node->key) {
+      if (is_black(node->right)) return balance_right(node->left, node->key, remove_recursive(node->right, key));
+      return make(Color::red, node->left, node->key, remove_recursive(node->right, key));
+    }
+
+    return append(node->left, node->right);
+  }
+
+  static void inorder_visit(const PersistentNode* node) {
+    if (!node) return;
+    inorder_visit(node->left.get());
+    node->print();
+    inorder_visit(node->right.get());
+  }
+
+public:
+  PersistentRedBlackTree() : root(nullptr), count(0) {}
+
+  persistent_node get_root() const { return root; }
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  // O(1): the returned tree shares every node with this one
+  PersistentRedBlackTree snapshot() const { return PersistentRedBlackTree(root, count); }
+
+  bool contains(int key) const {
+    const PersistentNode* node = root.get();
+    while (node && key != node->key) node = key < node->key ? node->left.get() : node->right.get();
+    return node != nullptr;
+  }
+
+  bool insert(int key) {
+    if (contains(key)) return false;
+    root = make_black(insert_recursive(root, key));
+    count++;
+    return true;
+  }
+
+  bool remove(int key) {
+    if (!contains(key)) return false;
+    root = make_black(remove_recursive(root, key));
+    count--;
+    return true;
+  }
+
+  // In-order traversal with an explicit stack, no refcount traffic while walking
+  template <typename Function>
+  void for_each(Function fn) const {
+    vector<const PersistentNode*> stack;
+    const PersistentNode* node = root.get();
+
+    while (node || !stack.empty()) {
+      while (node) {
+        stack.push_back(node);
+        node = node->left.get();
+      }
+      node = stack.back();
+      stack.pop_back();
+      fn(node->key);
+      node = node->right.get();
+    }
+  }
+
+  void inorder_visit() const { inorder_visit(root.get()); }
+};
+
+#endif
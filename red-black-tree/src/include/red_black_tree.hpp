@@ -1,23 +1,54 @@
 #ifndef BINARY_SEARCH_TREE_HPP
 #define BINARY_SEARCH_TREE_HPP
 
+#include <cstddef>
+#include <vector>
+
 #include "node.hpp"
+#include "parallel.hpp"
 
 using namespace std;
 
-class RedBlackTree {
+struct CompactionStats {
+  size_t compactions = 0;
+  size_t reclaimed_nodes = 0;
+  size_t reclaimed_bytes = 0;
+};
+
+struct MemoryUsage {
+  size_t keys = 0;
+  size_t node_bytes = 0;
+  size_t bytes = 0;
+
+  double bytes_per_key() const { return keys ? double(bytes) / keys : 0; }
+};
+
+// The tree owns every node passed to tree_insert (allocated with new) and frees it on
+// removal: tree_delete deletes the node right away, or in lazy mode marks it and the
+// next compaction deletes it. A node must not be used or deleted by the caller once it
+// has been passed to tree_delete.
+// NodeType is Node for a plain tree (RedBlackTree) or IntervalNode for an interval
+// tree (IntervalTree), which also maintains each subtree's max_high.
+template <typename NodeType>
+class BasicRedBlackTree {
 private:
-  Node* root;
-  Node* nil;
+  NodeType* root;
+  NodeType* nil;
+
+  bool lazy_delete = false;
+  double tombstone_ratio = 0.25;
+  size_t live_count = 0;
+  size_t tombstone_count = 0;
+  CompactionStats compaction_stats;
 
-  void fix_insert(Node* node) {
+  void fix_insert(NodeType* node) {
     node->color = Color::red;
 
     while (node != root && node->parent->color == Color::red) {
-      Node* grandparent = node->parent->parent;
+      NodeType* grandparent = node->parent->parent;
 
       if (node->parent == grandparent->left) {
-        Node* uncle = grandparent->right;
+        NodeType* uncle = grandparent->right;
 
         if (uncle->color == Color::red) {
           node->parent->color = Color::black;
@@ -34,7 +65,7 @@ private:
           right_rotate(grandparent);
         }
       } else {
-        Node* uncle = grandparent->left;
+        NodeType* uncle = grandparent->left;
 
         if (uncle->color == Color::red) {
           node->parent->color = Color::black;
@@ -56,7 +87,7 @@ private:
     root->color = Color::black;
   }
 
-  void transplant(Node* u, Node* v) {
+  void transplant(NodeType* u, NodeType* v) {
     if (u->parent == nil) {
       root = v;
     } else if (u == u->parent->left) {
@@ -67,10 +98,10 @@ private:
     v->parent = u->parent;
   }
 
-  void fix_delete(Node* x) {
+  void fix_delete(NodeType* x) {
     while (x != root && x->color == Color::black) {
       if (x == x->parent->left) {
-        Node* w = x->parent->right;
+        NodeType* w = x->parent->right;
         if (w->color == Color::red) {
           w->color = Color::black;
           x->parent->color = Color::red;
@@ -95,7 +126,7 @@ private:
           x = root;
         }
       } else {
-        Node* w = x->parent->left;
+        NodeType* w = x->parent->left;
         if (w->color == Color::red) {
           w->color = Color::black;
           x->parent->color = Color::red;
@@ -124,65 +155,192 @@ private:
     x->color = Color::black;
   }
 
+  // Leftmost node of the subtree, tombstones included
+  NodeType* subtree_minimum(NodeType* node) {
+    while (node->left != nil) node = node->left;
+    return node;
+  }
+
+  // Equal keys may sit on both sides of a tombstone, so both subtrees are searched
+  NodeType* live_search(NodeType* node, int key) {
+    if (node == nil) return nil;
+    if (key < node->key) return live_search(node->left, key);
+    if (key > node->key) return live_search(node->right, key);
+    if (!node->deleted) return node;
+
+    NodeType* found = live_search(node->left, key);
+    return found != nil ? found : live_search(node->right, key);
+  }
+
+  void collect_live(NodeType* node, vector<NodeType*>& live) {
+    if (node == nil) return;
+    collect_live(node->left, live);
+    NodeType* right = node->right;
+    if (node->deleted)
+      delete node;
+    else
+      live.push_back(node);
+    collect_live(right, live);
+  }
+
+  // Nodes on the deepest level are red and all others black, which keeps every
+  // root-to-nil path at the same black height for a size-balanced tree
+  NodeType* build_balanced(vector<NodeType*>& nodes, size_t low, size_t high, size_t depth, size_t max_depth, NodeType* parent) {
+    if (low >= high) return nil;
+
+    size_t mid = low + (high - low) / 2;
+    NodeType* node = nodes[mid];
+    node->parent = parent;
+    node->color = depth == max_depth ? Color::red : Color::black;
+    node->left = build_balanced(nodes, low, mid, depth + 1, max_depth, node);
+    node->right = build_balanced(nodes, mid + 1, high, depth + 1, max_depth, node);
+    update_max(node);
+    return node;
+  }
+
+  // Interval augmentation: only IntervalNode carries max_high, plain nodes skip the upkeep
+  void update_max(Node*) {}
+  void update_max(IntervalNode* node) {
+    node->max_high = node->high;
+    if (node->left->max_high > node->max_high) node->max_high = node->left->max_high;
+    if (node->right->max_high > node->max_high) node->max_high = node->right->max_high;
+  }
+
+  void raise_max(Node*, Node*) {}
+  void raise_max(IntervalNode* node, IntervalNode* inserted) {
+    if (node->max_high < inserted->high) node->max_high = inserted->high;
+  }
+
+  void update_max_upward(Node*) {}
+  void update_max_upward(IntervalNode* node) {
+    for (; node != nil; node = node->parent) update_max(node);
+  }
+
+  size_t bounded_size(NodeType* node, size_t limit) {
+    if (node == nil || limit == 0) return 0;
+    size_t count = 1 + bounded_size(node->left, limit - 1);
+    if (count < limit) count += bounded_size(node->right, limit - count);
+    return count;
+  }
+
+  // Splits the top levels of the tree into subtree tasks separated by the nodes above
+  // them: the in-order sequence is tasks[0], splits[0], tasks[1], ..., tasks.back().
+  // Subtrees smaller than cutoff are never split further.
+  void split_tasks(NodeType* node, size_t depth, size_t cutoff, vector<NodeType*>& tasks, vector<NodeType*>& splits) {
+    if (node == nil || depth == 0 || bounded_size(node, cutoff) < cutoff) {
+      tasks.push_back(node);
+      return;
+    }
+    split_tasks(node->left, depth - 1, cutoff, tasks, splits);
+    splits.push_back(node);
+    split_tasks(node->right, depth - 1, cutoff, tasks, splits);
+  }
+
+  template <typename Function>
+  void inorder_apply(NodeType* node, Function& fn) {
+    if (node == nil) return;
+    inorder_apply(node->left, fn);
+    if (!node->deleted) fn(node);
+    inorder_apply(node->right, fn);
+  }
+
+  void maybe_compact() {
+    if (tombstone_count > 0 && tombstone_count >= tombstone_ratio * (live_count + tombstone_count)) compact();
+  }
+
 public:
-  RedBlackTree() {
-    nil = new Node;
+  BasicRedBlackTree() {
+    nil = new NodeType;
     nil->color = Color::black;
     nil->left = nil->right = nil->parent = nil;
     root = nil;
   }
 
-  ~RedBlackTree() {
+  ~BasicRedBlackTree() {
     delete_subtree(root);
     delete nil;
   }
 
-  Node* get_root() const { return root; }
-  Node* get_nil() const { return nil; }
+  NodeType* get_root() const { return root; }
+  NodeType* get_nil() const { return nil; }
+
+  size_t size() const { return live_count; }
+  size_t get_tombstone_count() const { return tombstone_count; }
+  const CompactionStats& get_compaction_stats() const { return compaction_stats; }
 
-  void inorder_visit(Node* node) {
+  // Nodes (tombstones and sentinel included) plus the tree object itself. Each node is
+  // its own heap allocation and the allocator's per-allocation overhead (typically 8-16
+  // bytes per node with glibc malloc) is not counted, so the real footprint is higher
+  MemoryUsage memory_usage() const {
+    MemoryUsage usage;
+    usage.keys = live_count;
+    usage.node_bytes = sizeof(NodeType);
+    usage.bytes = (live_count + tombstone_count + 1) * sizeof(NodeType) + sizeof(*this);
+    return usage;
+  }
+
+  bool is_lazy_delete() const { return lazy_delete; }
+  void set_lazy_delete(bool enabled) {
+    lazy_delete = enabled;
+    if (!lazy_delete && tombstone_count > 0) compact();
+  }
+
+  double get_tombstone_ratio() const { return tombstone_ratio; }
+  void set_tombstone_ratio(double ratio) {
+    tombstone_ratio = ratio;
+    if (lazy_delete) maybe_compact();
+  }
+
+  void inorder_visit(NodeType* node) {
     if (node == nil) return;
     inorder_visit(node->left);
-    node->print();
+    if (!node->deleted) node->print();
     inorder_visit(node->right);
   }
 
-  void preorder_visit(Node* node) {
+  void preorder_visit(NodeType* node) {
     if (node == nil) return;
-    node->print();
+    if (!node->deleted) node->print();
     preorder_visit(node->left);
     preorder_visit(node->right);
   }
 
-  void postorder_visit(Node* node) {
+  void postorder_visit(NodeType* node) {
     if (node == nil) return;
     postorder_visit(node->left);
     postorder_visit(node->right);
-    node->print();
+    if (!node->deleted) node->print();
   }
 
-  Node* tree_search(Node* node, int key) {
+  NodeType* tree_search(NodeType* node, int key) {
     while (node != nil && key != node->key) {
       if (key < node->key)
         node = node->left;
       else
         node = node->right;
     }
+    if (node != nil && node->deleted) return live_search(node, key);
     return node;
   }
 
-  Node* tree_minimum(Node* node) {
-    while (node->left != nil) node = node->left;
-    return node;
+  // Smallest live node of the subtree, nil if it holds only tombstones
+  NodeType* tree_minimum(NodeType* node) {
+    if (node == nil) return nil;
+    NodeType* found = tree_minimum(node->left);
+    if (found != nil || !node->deleted) return found != nil ? found : node;
+    return tree_minimum(node->right);
   }
 
-  Node* tree_maximum(Node* node) {
-    while (node->right != nil) node = node->right;
-    return node;
+  // Largest live node of the subtree, nil if it holds only tombstones
+  NodeType* tree_maximum(NodeType* node) {
+    if (node == nil) return nil;
+    NodeType* found = tree_maximum(node->right);
+    if (found != nil || !node->deleted) return found != nil ? found : node;
+    return tree_maximum(node->left);
   }
 
-  void left_rotate(Node* x) {
-    Node* y = x->right;
+  void left_rotate(NodeType* x) {
+    NodeType* y = x->right;
     x->right = y->left;
     if (y->left != nil) y->left->parent = x;
     y->parent = x->parent;
@@ -194,10 +352,12 @@ public:
       x->parent->right = y;
     y->left = x;
     x->parent = y;
+    update_max(x);
+    update_max(y);
   }
 
-  void right_rotate(Node* x) {
-    Node* y = x->left;
+  void right_rotate(NodeType* x) {
+    NodeType* y = x->left;
     x->left = y->right;
     if (y->right != nil) y->right->parent = x;
     y->parent = x->parent;
@@ -209,13 +369,16 @@ public:
       x->parent->left = y;
     y->right = x;
     x->parent = y;
+    update_max(x);
+    update_max(y);
   }
 
-  void tree_insert(Node* z) {
-    Node* y = nil;
-    Node* x = root;
+  void tree_insert(NodeType* z) {
+    NodeType* y = nil;
+    NodeType* x = root;
     while (x != nil) {
       y = x;
+      raise_max(x, z);
       if (z->key < x->key)
         x = x->left;
       else
@@ -229,13 +392,32 @@ public:
     else
       y->right = z;
     z->left = z->right = nil;
+    update_max(z);
     z->color = Color::red;
+    z->deleted = false;
+    live_count++;
     fix_insert(z);
   }
 
-  void tree_delete(Node* z) {
-    Node* y = z;
-    Node* x;
+  // In lazy mode the node is only marked as deleted; it is freed by the next
+  // compaction, triggered once tombstones reach tombstone_ratio
+  void tree_delete(NodeType* z) {
+    if (lazy_delete) {
+      if (z->deleted) return;
+      z->deleted = true;
+      live_count--;
+      tombstone_count++;
+      maybe_compact();
+      return;
+    }
+
+    if (z->deleted)
+      tombstone_count--;
+    else
+      live_count--;
+
+    NodeType* y = z;
+    NodeType* x;
     Color y_original_color = y->color;
 
     if (z->left == nil) {
@@ -245,7 +427,7 @@ public:
       x = z->left;
       transplant(z, z->left);
     } else {
-      y = tree_minimum(z->right);
+      y = subtree_minimum(z->right);
       y_original_color = y->color;
       x = y->right;
       if (y->parent == z)
@@ -260,17 +442,104 @@ public:
       y->left->parent = y;
       y->color = z->color;
     }
+    update_max_upward(x->parent);
     if (y_original_color == Color::black) fix_delete(x);
+    delete z;
+  }
+
+  // Frees every tombstone and rebuilds the live nodes into a balanced tree in O(n)
+  void compact() {
+    if (tombstone_count == 0) return;
+
+    vector<NodeType*> live;
+    live.reserve(live_count);
+    collect_live(root, live);
+
+    size_t max_depth = 0;
+    while ((size_t(2) << max_depth) <= live.size()) max_depth++;
+    root = build_balanced(live, 0, live.size(), 0, max_depth, nil);
+    root->color = Color::black;
+
+    compaction_stats.compactions++;
+    compaction_stats.reclaimed_nodes += tombstone_count;
+    compaction_stats.reclaimed_bytes += tombstone_count * sizeof(NodeType);
+    tombstone_count = 0;
+  }
+
+  // IntervalTree only: appends every live interval overlapping [low, high]; subtrees whose max_high
+  // ends before low, or right subtrees starting after high, are never entered
+  void interval_search(NodeType* node, int low, int high, vector<NodeType*>& result) {
+    if (node == nil || node->max_high < low) return;
+    interval_search(node->left, low, high, result);
+    if (node->key > high) return;
+    if (!node->deleted && node->high >= low) result.push_back(node);
+    interval_search(node->right, low, high, result);
   }
 
-  void delete_subtree(Node* node) {
+  // fn is called once per live node, concurrently and in no particular order
+  template <typename Function>
+  void parallel_for_each(Function fn, ThreadPool& pool, size_t cutoff = 4096) {
+    vector<NodeType*> tasks, splits;
+    split_tasks(root, split_depth(pool.size()), cutoff, tasks, splits);
+
+    pool.run(tasks.size(), [&](size_t i) { inorder_apply(tasks[i], fn); });
+    for (NodeType* node : splits)
+      if (!node->deleted) fn(node);
+  }
+
+  // Folds map(node) over the live nodes in key order; combine must be associative
+  // and identity its neutral element
+  template <typename T, typename Map, typename Combine>
+  T parallel_reduce(T identity, Map map, Combine combine, ThreadPool& pool, size_t cutoff = 4096) {
+    vector<NodeType*> tasks, splits;
+    split_tasks(root, split_depth(pool.size()), cutoff, tasks, splits);
+
+    // Wrapped so that T = bool does not select the bit-packed vector<bool>
+    struct Partial {
+      T value;
+    };
+    vector<Partial> partials(tasks.size(), Partial{identity});
+    pool.run(tasks.size(), [&](size_t i) {
+      T accumulator = identity;
+      auto fold = [&](NodeType* node) { accumulator = combine(accumulator, map(node)); };
+      inorder_apply(tasks[i], fold);
+      partials[i].value = accumulator;
+    });
+
+    T result = partials[0].value;
+    for (size_t i = 0; i < splits.size(); i++) {
+      if (!splits[i]->deleted) result = combine(result, map(splits[i]));
+      result = combine(result, partials[i + 1].value);
+    }
+    return result;
+  }
+
+  // Appends the live nodes in key order, filling one buffer per subtree task
+  void parallel_inorder(vector<NodeType*>& result, ThreadPool& pool, size_t cutoff = 4096) {
+    vector<NodeType*> tasks, splits;
+    split_tasks(root, split_depth(pool.size()), cutoff, tasks, splits);
+
+    vector<vector<NodeType*>> buffers(tasks.size());
+    pool.run(tasks.size(), [&](size_t i) {
+      auto collect = [&](NodeType* node) { buffers[i].push_back(node); };
+      inorder_apply(tasks[i], collect);
+    });
+
+    result.insert(result.end(), buffers[0].begin(), buffers[0].end());
+    for (size_t i = 0; i < splits.size(); i++) {
+      if (!splits[i]->deleted) result.push_back(splits[i]);
+      result.insert(result.end(), buffers[i + 1].begin(), buffers[i + 1].end());
+    }
+  }
+
+  void delete_subtree(NodeType* node) {
     if (node == nil) return;
     delete_subtree(node->left);
     delete_subtree(node->right);
     delete node;
   }
 
-  void print_tree(Node* node, string prefix = "", bool is_left = true) {
+  void print_tree(NodeType* node, string prefix = "", bool is_left = true) {
     if (node == nil) return;
     cout << prefix << (is_left ? "├── " : "└── ");
     node->print();
@@ -279,4 +548,7 @@ public:
   }
 };
 
+using RedBlackTree = BasicRedBlackTree<Node>;
+using IntervalTree = BasicRedBlackTree<IntervalNode>;
+
 #endif
@@ -1,3 +1,4 @@
+#include "./include/persistent_red_black_tree.hpp"
 #include "./include/red_black_tree.hpp"
 
 int main() {
@@ -33,5 +34,29 @@ int main() {
     cout << endl;
   }
 
+  PersistentRedBlackTree persistent;
+  for (int key : {10, 20, 30, 15, 25, 5, 1, 21}) persistent.insert(key);
+
+  PersistentRedBlackTree snapshot = persistent.snapshot();
+  persistent.remove(10);
+  persistent.insert(12);
+
+  cout << endl << "Persistent tree (snapshot):" << endl;
+  snapshot.inorder_visit();
+  cout << endl << "Persistent tree (current):" << endl;
+  persistent.inorder_visit();
+
+  IntervalTree intervals;
+  intervals.tree_insert(create_interval_node(5, 20));
+  intervals.tree_insert(create_interval_node(10, 30));
+  intervals.tree_insert(create_interval_node(12, 15));
+  intervals.tree_insert(create_interval_node(17, 19));
+  intervals.tree_insert(create_interval_node(30, 40));
+
+  vector<IntervalNode*> overlapping;
+  intervals.interval_search(intervals.get_root(), 14, 16, overlapping);
+  cout << endl << "Intervals overlapping [14, 16]:" << endl;
+  for (IntervalNode* interval : overlapping) interval->print();
+
   return 0;
 }
\ No newline at end of file